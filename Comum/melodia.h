@@ -0,0 +1,729 @@
+/**************************************************
+ * Pré-IC - Núcleo comum dos geradores de melodias
+ *
+ * Estruturas e funções compartilhadas pelos três
+ * geradores. As funções são definidas como static
+ * inline para que cada programa continue sendo
+ * compilado a partir de um único arquivo .c.
+ *
+ * Autor: Rafael Marasca Martins
+ **************************************************/
+
+#ifndef MELODIA_H
+#define MELODIA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <windows.h>
+#include <math.h>
+
+//Tamanho do buffer utilizado na impressão das tabelas.
+#define OUTPUT_BUFFER_SIZE 65536
+
+//Espaço livre mínimo no buffer antes da inserção de uma nova linha.
+#define OUTPUT_LINE_MAX 256
+
+//Duração de um compasso 4/4 em semifusas (figura 0).
+#define BAR_SIZE 64
+
+//Formatos de saída das tabelas.
+#define FORMAT_TABLE 0 //Tabela com bordas (padrão).
+#define FORMAT_CSV   1 //Valores separados por vírgula.
+#define FORMAT_JSONL 2 //Um objeto JSON por linha.
+
+//Cabeçalho único do formato CSV. Todas as tabelas (notas, dados e matriz) usam
+//estas colunas; os campos que não se aplicam a uma tabela ficam vazios.
+#define CSV_HEADER "tabela,melodia,nota,midi,frequencia,figura,duracao,bits,dados,soma,linha,valores\n"
+
+/******************************************************
+ * Estrutura options_t
+ *
+ * Representa as opções passadas por linha de comando
+ *******************************************************/
+typedef struct
+{
+    unsigned int seed;  //Semente (semente mestre no modo em lote).
+    int quiet;          //Indica se as tabelas intermediárias e a semente devem ser omitidas.
+    int format;         //Formato de saída das tabelas (FORMAT_TABLE, FORMAT_CSV ou FORMAT_JSONL).
+    int batch;          //Indica se o programa está no modo em lote.
+    unsigned int first; //Índice da primeira melodia do lote.
+    unsigned int last;  //Índice seguinte ao da última melodia do lote.
+    unsigned int melody;//Índice da melodia sendo gerada (0 fora do modo em lote).
+}options_t;
+
+/******************************************************
+ * Estrutura node_t
+ *
+ * Representa uma nota e suas propriedades
+ *******************************************************/
+typedef struct
+{
+    int midi;      //Representa o numero midi da nota.
+    int frequency; //Representa a frequência da nota.
+    int figure;    //Representa a figura rítmica da nota.
+    int duration;  //Representa a duração em milissegundos.
+}note_t;
+
+
+/************************************************************
+ * Função: get_frequency
+ *
+ * Retorna a frequência em Hz da nota passada por parâmetro.
+ * As frequências das notas midi (0 a 127) são calculadas uma
+ * única vez e armazenadas em uma tabela interna.
+ *
+ * Parâmetros:
+ * - note: valor midi da nota cuja frequência é desejada.
+ ************************************************************/
+static inline double get_frequency(int note)
+{
+    //Tabela que armazena as frequências já calculadas (0 indica não calculada).
+    static double frequency_table[128] = {0};
+
+    //Variável auxiliar.
+    double power = (note - 69)/12.0;
+
+    //Notas fora da faixa midi não são armazenadas na tabela.
+    if(note < 0 || note > 127)
+        return 440*pow(2,power);
+
+    //Calcula a frequência com base na frequência do Lá Central (69) apenas na primeira vez.
+    if(frequency_table[note] == 0)
+        frequency_table[note] = 440*pow(2,power);
+
+    return frequency_table[note];
+}
+
+
+/****************************************************************
+ * Função: append_text
+ *
+ * Copia um texto para o final do buffer de saída.
+ *
+ * Parâmetros:
+ * - buffer: posição do buffer onde o texto será copiado.
+ * - text: texto a ser copiado.
+ *
+ * Retorna o número de caracteres copiados.
+ ***************************************************************/
+static inline size_t append_text(char* buffer, const char* text)
+{
+    size_t length = strlen(text);
+
+    memcpy(buffer, text, length);
+
+    return length;
+}
+
+
+/****************************************************************
+ * Função: append_int
+ *
+ * Converte um inteiro em texto, alinhado à direita, diretamente
+ * no buffer de saída (equivalente a printf("%*d")).
+ *
+ * Parâmetros:
+ * - buffer: posição do buffer onde o número será escrito.
+ * - value: valor a ser convertido.
+ * - width: largura mínima do campo, completada com espaços.
+ *
+ * Retorna o número de caracteres escritos.
+ ***************************************************************/
+static inline size_t append_int(char* buffer, int value, int width)
+{
+    //Vetor auxiliar que armazena os dígitos em ordem inversa.
+    char digits[12];
+
+    //Valor absoluto do número (unsigned para suportar INT_MIN).
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    int length = 0;
+    size_t pos = 0;
+
+    do
+    {
+        digits[length++] = '0' + (magnitude%10);
+        magnitude /= 10;
+    }while(magnitude > 0);
+
+    if(value < 0)
+        digits[length++] = '-';
+
+    //Completa a largura mínima com espaços à esquerda.
+    for(int i = length; i < width; i++)
+        buffer[pos++] = ' ';
+
+    while(length > 0)
+        buffer[pos++] = digits[--length];
+
+    return pos;
+}
+
+
+/****************************************************************
+ * Função: append_uint
+ *
+ * Converte um inteiro sem sinal em texto, alinhado à direita,
+ * diretamente no buffer de saída (equivalente a printf("%*u")).
+ *
+ * Parâmetros:
+ * - buffer: posição do buffer onde o número será escrito.
+ * - value: valor a ser convertido.
+ * - width: largura mínima do campo, completada com espaços.
+ *
+ * Retorna o número de caracteres escritos.
+ ***************************************************************/
+static inline size_t append_uint(char* buffer, unsigned int value, int width)
+{
+    //Vetor auxiliar que armazena os dígitos em ordem inversa.
+    char digits[12];
+
+    int length = 0;
+    size_t pos = 0;
+
+    do
+    {
+        digits[length++] = '0' + (value%10);
+        value /= 10;
+    }while(value > 0);
+
+    //Completa a largura mínima com espaços à esquerda.
+    for(int i = length; i < width; i++)
+        buffer[pos++] = ' ';
+
+    while(length > 0)
+        buffer[pos++] = digits[--length];
+
+    return pos;
+}
+
+
+/****************************************************************
+ * Função: flush_buffer
+ *
+ * Escreve o conteúdo do buffer na saída padrão com uma única
+ * chamada de escrita.
+ *
+ * Parâmetros:
+ * - buffer: buffer de saída.
+ * - size: número de caracteres armazenados no buffer.
+ *
+ * Retorna a nova posição do buffer (0).
+ ***************************************************************/
+static inline size_t flush_buffer(const char* buffer, size_t size)
+{
+    if(size > 0)
+        fwrite(buffer, 1, size, stdout);
+
+    return 0;
+}
+
+
+/****************************************************************
+ * Função: print_song
+ *
+ * Imprime uma tabela contendo a sequência das notas utilizadas
+ * na melodia, as respectivas frequências, figuras rítmicas e
+ * duração em milissegundos.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ ***************************************************************/
+static inline void print_song(note_t* song, unsigned int notes_num)
+{
+    //Buffer que acumula as linhas da tabela antes da impressão.
+    static char buffer[OUTPUT_BUFFER_SIZE];
+
+    //Posição atual no buffer.
+    size_t pos = 0;
+
+    pos += append_text(buffer+pos, "+----+----------+------+-----------+\n");
+    pos += append_text(buffer+pos, "|MIDI|FREQUENCIA|FIGURA|DURACAO(ms)|\n");
+    pos += append_text(buffer+pos, "+----+----------+------+-----------+\n");
+
+    for(int i = 0; i<notes_num; i++)
+    {
+        //Esvazia o buffer quando não houver espaço para mais uma linha.
+        if(pos > OUTPUT_BUFFER_SIZE - OUTPUT_LINE_MAX)
+            pos = flush_buffer(buffer, pos);
+
+        //Equivalente a "| %2d |   %4d   |   %d  |   %5d   |\n".
+        pos += append_text(buffer+pos, "| ");
+        pos += append_int(buffer+pos, song[i].midi, 2);
+        pos += append_text(buffer+pos, " |   ");
+        pos += append_int(buffer+pos, song[i].frequency, 4);
+        pos += append_text(buffer+pos, "   |   ");
+        pos += append_int(buffer+pos, song[i].figure, 1);
+        pos += append_text(buffer+pos, "  |   ");
+        pos += append_int(buffer+pos, song[i].duration, 5);
+        pos += append_text(buffer+pos, "   |\n");
+    }
+
+    pos += append_text(buffer+pos, "+----------------------------------+\n");
+
+    flush_buffer(buffer, pos);
+}
+
+
+/****************************************************************
+ * Função: print_song_csv
+ *
+ * Imprime as notas da melodia no formato CSV, uma nota por linha,
+ * com as colunas de CSV_HEADER (bits, dados, soma, linha e valores
+ * ficam vazios). O cabeçalho é impresso por print_csv_header.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ * - melody: índice da melodia.
+ ***************************************************************/
+static inline void print_song_csv(note_t* song, unsigned int notes_num, unsigned int melody)
+{
+    //Buffer que acumula as linhas da tabela antes da impressão.
+    static char buffer[OUTPUT_BUFFER_SIZE];
+
+    //Posição atual no buffer.
+    size_t pos = 0;
+
+    for(int i = 0; i<notes_num; i++)
+    {
+        //Esvazia o buffer quando não houver espaço para mais uma linha.
+        if(pos > OUTPUT_BUFFER_SIZE - OUTPUT_LINE_MAX)
+            pos = flush_buffer(buffer, pos);
+
+        pos += append_text(buffer+pos, "notas,");
+        pos += append_uint(buffer+pos, melody, 0);
+        buffer[pos++] = ',';
+        pos += append_int(buffer+pos, i, 0);
+        buffer[pos++] = ',';
+        pos += append_int(buffer+pos, song[i].midi, 0);
+        buffer[pos++] = ',';
+        pos += append_int(buffer+pos, song[i].frequency, 0);
+        buffer[pos++] = ',';
+        pos += append_int(buffer+pos, song[i].figure, 0);
+        buffer[pos++] = ',';
+        pos += append_int(buffer+pos, song[i].duration, 0);
+        pos += append_text(buffer+pos, ",,,,,\n");
+    }
+
+    flush_buffer(buffer, pos);
+}
+
+
+/****************************************************************
+ * Função: print_csv_header
+ *
+ * Imprime o cabeçalho CSV, uma única vez por saída. No modo em
+ * lote ele só é impresso pelo lote que começa na melodia 0, para
+ * que as saídas de lotes complementares possam ser concatenadas.
+ *
+ * Parâmetros:
+ * - options: opções passadas por linha de comando.
+ ***************************************************************/
+static inline void print_csv_header(const options_t* options)
+{
+    if(options->format == FORMAT_CSV && options->first == 0)
+        printf(CSV_HEADER);
+}
+
+
+/****************************************************************
+ * Função: print_song_jsonl
+ *
+ * Imprime as notas da melodia no formato JSON Lines, um objeto
+ * por nota.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ * - melody: índice da melodia.
+ ***************************************************************/
+static inline void print_song_jsonl(note_t* song, unsigned int notes_num, unsigned int melody)
+{
+    //Buffer que acumula as linhas da tabela antes da impressão.
+    static char buffer[OUTPUT_BUFFER_SIZE];
+
+    //Posição atual no buffer.
+    size_t pos = 0;
+
+    for(int i = 0; i<notes_num; i++)
+    {
+        //Esvazia o buffer quando não houver espaço para mais uma linha.
+        if(pos > OUTPUT_BUFFER_SIZE - OUTPUT_LINE_MAX)
+            pos = flush_buffer(buffer, pos);
+
+        pos += append_text(buffer+pos, "{\"tabela\":\"notas\",\"melodia\":");
+        pos += append_uint(buffer+pos, melody, 0);
+        pos += append_text(buffer+pos, ",\"nota\":");
+        pos += append_int(buffer+pos, i, 0);
+        pos += append_text(buffer+pos, ",\"midi\":");
+        pos += append_int(buffer+pos, song[i].midi, 0);
+        pos += append_text(buffer+pos, ",\"frequencia\":");
+        pos += append_int(buffer+pos, song[i].frequency, 0);
+        pos += append_text(buffer+pos, ",\"figura\":");
+        pos += append_int(buffer+pos, song[i].figure, 0);
+        pos += append_text(buffer+pos, ",\"duracao\":");
+        pos += append_int(buffer+pos, song[i].duration, 0);
+        pos += append_text(buffer+pos, "}\n");
+    }
+
+    flush_buffer(buffer, pos);
+}
+
+
+/****************************************************************
+ * Função: output_song
+ *
+ * Imprime as notas da melodia no formato selecionado por linha
+ * de comando.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ * - options: opções passadas por linha de comando.
+ ***************************************************************/
+static inline void output_song(note_t* song, unsigned int notes_num, const options_t* options)
+{
+    switch(options->format)
+    {
+        case FORMAT_CSV:
+            print_song_csv(song, notes_num, options->melody);
+        break;
+
+        case FORMAT_JSONL:
+            print_song_jsonl(song, notes_num, options->melody);
+        break;
+
+        default:
+            print_song(song, notes_num);
+        break;
+    }
+}
+
+
+/****************************************************************
+ * Função: play_song
+ *
+ * Toca a melodia composta utilizando a função beep.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ ***************************************************************/
+static inline void play_song(note_t* song, unsigned int notes_num)
+{
+    //Toca a frequência de cada nota por um tempo igual a sua duração.
+    for(int i = 0; i < notes_num; i++)
+    {
+        Beep(song[i].frequency, song[i].duration);
+    }
+}
+
+
+/****************************************************************
+ * Função: choose_figure
+ *
+ * Sorteia uma figura rítmica que caiba no espaço restante do
+ * compasso, de forma que a soma das figuras complete compassos
+ * inteiros. Cada figura tem um peso (figure_weight) e o sorteio é
+ * feito entre as figuras que cabem, proporcionalmente aos pesos.
+ * Os pesos crescem com a duração para compensar o fato de que as
+ * figuras longas cabem em menos posições do compasso; com eles, a
+ * frequência de longo prazo de cada uma das sete figuras fica
+ * próxima de 1/7, como no sorteio uniforme sem compasso.
+ *
+ * Os pesos acumulados para cada espaço restante são calculados
+ * uma única vez e armazenados em uma tabela.
+ *
+ * Parâmetros:
+ * - bar_space: espaço restante no compasso atual, em semifusas
+ *              (deve ser iniciado com BAR_SIZE). É atualizado
+ *              com a figura sorteada.
+ *
+ * Retorna a figura sorteada (0 = semifusa ... 6 = semibreve).
+ ***************************************************************/
+static inline int choose_figure(int* bar_space)
+{
+    //Peso de cada figura no sorteio.
+    static const int figure_weight[7] = {2, 3, 4, 6, 9, 15, 40};
+
+    //Pesos acumulados das figuras que cabem em cada espaço restante (0 indica não calculada).
+    static int cumulative_weight[BAR_SIZE+1][7] = {{0}};
+
+    //Número de figuras que cabem em cada espaço restante.
+    static int figures_num[BAR_SIZE+1] = {0};
+
+    //Variável auxiliar.
+    int value = 0;
+
+    int figure = 0;
+
+    //Preenche as tabelas na primeira chamada (figura i dura 2^i semifusas).
+    if(figures_num[1] == 0)
+    {
+        for(int space = 1; space <= BAR_SIZE; space++)
+        {
+            while(figures_num[space] < 7 && (1<<figures_num[space]) <= space)
+            {
+                cumulative_weight[space][figures_num[space]] = figure_weight[figures_num[space]]
+                    + ((figures_num[space] > 0) ? cumulative_weight[space][figures_num[space]-1] : 0);
+
+                figures_num[space]++;
+            }
+        }
+    }
+
+    //Sorteia um valor entre 0 e a soma dos pesos das figuras que cabem.
+    value = rand()%cumulative_weight[*bar_space][figures_num[*bar_space]-1];
+
+    while(value >= cumulative_weight[*bar_space][figure])
+        figure++;
+
+    //Desconta a figura do compasso e inicia um novo compasso quando ele for completado.
+    *bar_space -= (1<<figure);
+
+    if(*bar_space == 0)
+        *bar_space = BAR_SIZE;
+
+    return figure;
+}
+
+
+/****************************************************************
+ * Função: set_tempo
+ *
+ * Atribui a duração das notas de acordo com suas figuras rítmicas
+ * e o andamento. Pode ser chamada sobre uma melodia já gerada para
+ * alterar o andamento sem modificar as notas e as figuras.
+ *
+ * Parâmetros:
+ * - song: vetor de notas que compõem a melodia.
+ * - notes_num: número de notas da melodia.
+ * - seminima: número de semínimas por minuto na melodia.
+ ***************************************************************/
+static inline void set_tempo(note_t* song, unsigned int notes_num, unsigned int seminima)
+{
+    //Vetor que armazena a duração das figuras rítmicas.
+    int duration[7] = {0};
+
+    //Computa a duração de uma semínima.
+    duration[4] = (60000.0)/seminima;
+
+    //Calcula as durações das demais figuras rítmicas (cada figura dura o dobro da anterior).
+    for(int i = 0; i< 4; i++)
+        duration[i] = duration[4]>>(4-i);
+
+    for(int i = 5; i< 7; i++)
+        duration[i] = duration[4]<<(i-4);
+
+    //Atribui a duração de cada nota de acordo com sua figura rítmica.
+    for(int i = 0; i < notes_num; i++)
+    {
+        song[i].duration = duration[song[i].figure];
+    }
+}
+
+
+/****************************************************************
+ * Função: parse_unsigned
+ *
+ * Converte um texto em um inteiro sem sinal. O texto deve conter
+ * apenas dígitos e o valor deve caber em um unsigned int.
+ *
+ * Parâmetros:
+ * - text: texto a ser convertido.
+ * - value: variável onde o valor convertido será armazenado.
+ *
+ * Retorna 0 em caso de sucesso e -1 se o texto for inválido.
+ ***************************************************************/
+static inline int parse_unsigned(const char* text, unsigned int* value)
+{
+    //Armazena a posição onde a conversão terminou.
+    char* end = NULL;
+
+    //Variável auxiliar.
+    unsigned long number = 0;
+
+    //Rejeita textos vazios, sinais e espaços, que strtoul aceitaria silenciosamente.
+    if(!isdigit((unsigned char)text[0]))
+        return -1;
+
+    errno = 0;
+    number = strtoul(text, &end, 10);
+
+    //Verifica se todo o texto foi utilizado e se o valor cabe em um unsigned int.
+    if(*end != '\0' || errno == ERANGE || number > UINT_MAX)
+        return -1;
+
+    *value = (unsigned int)number;
+
+    return 0;
+}
+
+
+/****************************************************************
+ * Função: parse_seed
+ *
+ * Lê a semente passada por linha de comando, imprimindo uma
+ * mensagem de erro caso ela seja inválida.
+ *
+ * Parâmetros:
+ * - text: argumento da linha de comando.
+ * - seed: variável onde a semente será armazenada.
+ *
+ * Retorna 0 em caso de sucesso e -1 se a semente for inválida.
+ ***************************************************************/
+static inline int parse_seed(const char* text, unsigned int* seed)
+{
+    if(parse_unsigned(text, seed) != 0)
+    {
+        printf("Semente invalida: %s\n", text);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************
+ * Função: parse_options
+ *
+ * Lê as opções passadas por linha de comando no formato
+ * "programa [-q] [-f formato] [semente [inicio fim]]". Quando o
+ * intervalo é informado, o programa entra no modo em lote e gera
+ * as melodias de índice inicio até fim-1. A opção -q ativa o modo
+ * silencioso, que omite as tabelas intermediárias e a semente, e
+ * a opção -f seleciona o formato das tabelas (tabela, csv ou jsonl).
+ *
+ * Parâmetros:
+ * - argc: número de argumentos da linha de comando.
+ * - argv: argumentos da linha de comando.
+ * - options: estrutura onde as opções serão armazenadas.
+ *
+ * Retorna 0 em caso de sucesso e -1 se alguma opção for inválida.
+ ***************************************************************/
+static inline int parse_options(int argc, char* argv[], options_t* options)
+{
+    //Armazena os argumentos que não são opções (semente, inicio e fim).
+    char* values[3] = {NULL};
+
+    //Número de argumentos que não são opções.
+    int values_num = 0;
+
+    //Sem semente, utiliza o horário atual.
+    options->seed = (unsigned)time(NULL);
+    options->quiet = 0;
+    options->format = FORMAT_TABLE;
+    options->batch = 0;
+    options->first = 0;
+    options->last = 0;
+    options->melody = 0;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-q") == 0)
+        {
+            options->quiet = 1;
+
+        }else if(strcmp(argv[i], "-f") == 0 && i+1 < argc)
+        {
+            i++;
+
+            if(strcmp(argv[i], "tabela") == 0)
+                options->format = FORMAT_TABLE;
+            else if(strcmp(argv[i], "csv") == 0)
+                options->format = FORMAT_CSV;
+            else if(strcmp(argv[i], "jsonl") == 0)
+                options->format = FORMAT_JSONL;
+            else
+            {
+                values_num = -1;
+                break;
+            }
+
+        }else if(argv[i][0] != '-' && values_num < 3)
+        {
+            values[values_num++] = argv[i];
+
+        }else
+        {
+            values_num = -1;
+            break;
+        }
+    }
+
+    if(values_num < 0 || values_num == 2)
+    {
+        printf("Uso: %s [-q] [-f tabela|csv|jsonl] [semente [inicio fim]]\n", argv[0]);
+        return -1;
+    }
+
+    //Utiliza a semente passada por linha de comando, caso exista, para que a melodia possa ser reproduzida.
+    if(values_num > 0 && parse_seed(values[0], &options->seed) != 0)
+        return -1;
+
+    if(values_num == 3)
+    {
+        if(parse_unsigned(values[1], &options->first) != 0 || parse_unsigned(values[2], &options->last) != 0
+           || options->first > options->last)
+        {
+            printf("Intervalo invalido: %s %s\n", values[1], values[2]);
+            return -1;
+        }
+
+        options->batch = 1;
+    }
+
+    return 0;
+}
+
+
+/****************************************************************
+ * Função: melody_seed
+ *
+ * Deriva a semente de uma melodia do lote a partir da semente
+ * mestre e do índice da melodia (mistura do splitmix64). Como a
+ * semente depende apenas do índice, cada melodia é gerada da
+ * mesma forma independentemente de como o lote é dividido.
+ *
+ * Parâmetros:
+ * - seed: semente mestre.
+ * - index: índice da melodia.
+ ***************************************************************/
+static inline unsigned int melody_seed(unsigned int seed, unsigned int index)
+{
+    unsigned long long value = ((unsigned long long)seed << 32) | index;
+
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    value = value ^ (value >> 31);
+
+    return (unsigned int)value;
+}
+
+
+/****************************************************************
+ * Função: print_prompt
+ *
+ * Imprime uma pergunta ao usuário. No modo em lote e nos formatos
+ * csv e jsonl os parâmetros são lidos da entrada sem que as
+ * perguntas sejam impressas, para não misturá-las aos dados.
+ *
+ * Parâmetros:
+ * - options: opções passadas por linha de comando.
+ * - text: texto da pergunta.
+ ***************************************************************/
+static inline void print_prompt(const options_t* options, const char* text)
+{
+    if(!options->batch && options->format == FORMAT_TABLE)
+        printf("%s", text);
+}
+
+#endif
@@ -7,22 +7,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <windows.h>
-#include <time.h>
-#include <math.h>
-
-/******************************************************
- * Estrutura node_t
- * 
- * Representa uma nota e suas propriedades
- *******************************************************/
-typedef struct 
-{
-    int midi;      //Representa o numero midi da nota.
-    int frequency; //Representa a frequência da nota.
-    int figure;    //Representa a figura rítmica da nota.
-    int duration;  //Representa a duração em milissegundos.
-}note_t;
+#include "../Comum/melodia.h"
 
 /************************************************************
  * Função: generate_song
@@ -33,48 +18,24 @@ typedef struct
  * - song: vetor onde a melodia será armazenada.
  * - notes_num: número de notas da melodia.
  * - seminima: número de semínimas por segundo na melodia.
+ * - seed: semente utilizada na geração de números aleatórios.
  ************************************************************/
-void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima);
-
-
-/************************************************************
- * Função: get_frequency
- * 
- * Retorna a frequência em Hz da nota passada por parâmetro.
- * 
- * Parâmetros:
- * - note: valor midi da nota cuja frequência é desejada.
- ************************************************************/
-double get_frequency(int note);
+void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, unsigned int seed);
 
 
 /****************************************************************
- * Função: print_song
- * 
- * Imprime uma tabela contendo a sequência das notas utilizadas
- * na melodia, as respectivas frequências, figuras rítmicas e 
- * duração em milissegundos.
+ * Função: random_step
  * 
- * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
+ * Retorna um deslocamento aleatório entre -4 e 4 para o índice
+ * da nota anterior.
  ***************************************************************/
-void print_song(note_t* song, unsigned int notes_num);
-
+int random_step(void);
 
-/****************************************************************
- * Função: play_song
- * 
- * Toca a melodia composta utilizando a função beep.
- * 
- * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
- ***************************************************************/
-void play_song(note_t* song, unsigned int notes_num);
-
-int main()
+int main(int argc, char* argv[])
 {
+    //Armazena as opções passadas por linha de comando.
+    options_t options;
+
     //Armazena a quantidade de seminimas por segundo.
     unsigned seminima = 0;
 
@@ -84,10 +45,14 @@ int main()
     //Vetor que armazenam as notas utilizadas na melodia.
     note_t* song = NULL;
 
-    printf("Numero de notas da melodia:");
+    //Lê a semente e o intervalo do lote passados por linha de comando.
+    if(parse_options(argc, argv, &options) != 0)
+        return -1;
+
+    print_prompt(&options, "Numero de notas da melodia:");
     scanf("%u", &notes_num);
 
-    printf("Seminimas por minuto:");
+    print_prompt(&options, "Seminimas por minuto:");
     scanf("%u", &seminima);
 
     //Aloca memória para as notas da melodia
@@ -100,16 +65,63 @@ int main()
         return -1;
     }
 
-    generate_song(song,notes_num,seminima);
+    //Imprime o cabeçalho CSV antes de qualquer tabela.
+    print_csv_header(&options);
+
+    //No modo em lote, gera cada melodia do intervalo com uma semente derivada de seu índice.
+    if(options.batch)
+    {
+        for(unsigned int index = options.first; index < options.last; index++)
+        {
+            options.melody = index;
+
+            //O título vem antes da geração, que imprime as tabelas intermediárias da melodia.
+            if(options.format == FORMAT_TABLE)
+                printf("Melodia %u:\n", index);
+
+            generate_song(song,notes_num,seminima,melody_seed(options.seed, index));
+
+            output_song(song, notes_num, &options);
+        }
+
+        free(song);
+
+        return 0;
+    }
+
+    generate_song(song,notes_num,seminima,options.seed);
 
-    printf("Melodia Gerada:\n");
+    //A semente e o título são impressos apenas no formato de tabela, e a semente é omitida no modo silencioso.
+    if(options.format == FORMAT_TABLE)
+    {
+        if(!options.quiet)
+            printf("Semente utilizada: %u\n", options.seed);
+
+        printf("Melodia Gerada:\n");
+    }
 
     //Imprime a tabela de notas.
-    print_song(song, notes_num);
+    output_song(song, notes_num, &options);
 
     //Toca a melodia
     play_song(song, notes_num);
 
+    /*Permite alterar o andamento da melodia sem gerá-la novamente. Nos formatos csv e jsonl
+    a melodia é impressa uma única vez, para que cada par (melodia, nota) identifique uma só linha.*/
+    while(options.format == FORMAT_TABLE)
+    {
+        print_prompt(&options, "Novas seminimas por minuto (0 para sair):");
+
+        if(scanf("%u", &seminima) != 1 || seminima == 0)
+            break;
+
+        set_tempo(song, notes_num, seminima);
+
+        output_song(song, notes_num, &options);
+
+        play_song(song, notes_num);
+    }
+
     if(song != NULL)
         free(song);
 
@@ -118,7 +130,7 @@ int main()
 
 
 //Definição da função generate_song
-void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima)
+void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, unsigned int seed)
 {
     //Vetor que armazena as notas que serão utilizadas para compor as melodias.
     const int notes[15] = {48, 50, 52, 53, 55, 57, 59, 60, 62, 64, 65, 67, 69, 71, 72};
@@ -126,27 +138,17 @@ void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima)
     //Vetor que armazena os índices das possíveis notas iniciais (Dó e Sol).
     const int first_note[5] = {0,4,7,11,14};
 
-    //Vetor que armazena a duração das figuras rítmicas.
-    int duration[7] = {0};
-
     //Variável auxiliar que representa a última nota utilizada na melodia.
     int last_note_index = 0;
 
     //Variável auxiliar.
     int temp = 0;
 
-    //Semente para geração de números aleatórios
-    srand((unsigned)time(NULL));
-
-    //Computa a duração de uma semínima.
-    duration[4] = (60000.0)/seminima;
+    //Espaço restante no compasso atual, em semifusas.
+    int bar_space = BAR_SIZE;
 
-    //Calcula as durações das demais figuras rítmicas.
-    for(int i = 0; i< 7; i++)
-    {
-        if(i != 4)
-          duration[i] = duration[4]*pow(2,i-4);
-    }
+    //Semente para geração de números aleatórios
+    srand(seed);
 
     //Gera a melodia conforme as regras estabelecidas
     for(int i = 0; i<notes_num; i++)
@@ -178,13 +180,11 @@ void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima)
             do
             {
                 //Soma um valor aleatório entre 4 e -4 à nota anterior
-                temp = last_note_index + ((rand()%5)*pow(-1,rand()%2));
+                temp = last_note_index + random_step();
                 
                 //Impede que o índice ultrapasse os limites do vetor (borda não reflectante)
-                while(temp <0)
-                    temp++;
-                while(temp>14)
-                    temp--;
+                temp = (temp < 0) ? 0 : temp;
+                temp = (temp > 14) ? 14 : temp;
 
             }while(notes[temp] == 59 || notes[temp] == 71);//Repete enquanto a nota não for um si.
 
@@ -216,62 +216,29 @@ void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima)
         }else
         {
             //Soma um valor aleatório entre -4 e 4 à nota anterior
-            last_note_index += ((rand()%5)*pow(-1,rand()%2));
+            last_note_index += random_step();
 
             //Impede que o índice ultrapasse os limites do vetor (borda não reflectante)
-            while(last_note_index<0)
-                last_note_index++;
-            while(last_note_index>14)
-                last_note_index--;
+            last_note_index = (last_note_index < 0) ? 0 : last_note_index;
+            last_note_index = (last_note_index > 14) ? 14 : last_note_index;
 
             song[i].frequency = get_frequency(notes[last_note_index]);
             song[i].midi = notes[last_note_index];
         }
         
-        //Atribui uma figura rítmica aleatória à nota.
-        song[i].figure = rand()%7;
-
-        //Atribui a duração da nota de acordo com sua figura rítmica.
-        song[i].duration = duration[song[i].figure];
+        //Atribui uma figura rítmica aleatória que caiba no compasso atual.
+        song[i].figure = choose_figure(&bar_space);
     }
 
+    //Atribui a duração das notas de acordo com o andamento.
+    set_tempo(song, notes_num, seminima);
 }
 
-//Definicação da função get_frequency.
-double get_frequency(int note)
+//Definição da função random_step.
+int random_step(void)
 {
-    //Calcula a frequência com base na frequência do Lá Central (69).
-    double power = (note - 69)/12.0;
-    return 440*pow(2,power);
-}
-
+    //Sorteia o tamanho do passo (0 a 4) e, em seguida, o seu sentido.
+    int step = rand()%5;
 
-//Definicação da função print_song.
-void print_song(note_t* song, unsigned int notes_num)
-{
-    printf("+----+----------+------+-----------+\n");
-    printf("|MIDI|FREQUENCIA|FIGURA|DURACAO(ms)|\n");
-    printf("+----+----------+------+-----------+\n");
-    for(int i = 0; i<notes_num; i++)
-    {
-        printf("| %d |   %4d   |   %d  |   %5d   |\n", song[i].midi, song[i].frequency, 
-        song[i].figure, song[i].duration);
-    }
-    printf("+----------------------------------+\n");
+    return (rand()%2) ? -step : step;
 }
-
-//Definicação da função play_song.
-void play_song(note_t* song, unsigned int notes_num)
-{
-    //Toca a frequência de cada nota por um tempo igual a sua duração.
-    for(int i = 0; i < notes_num; i++)
-    {
-        Beep(song[i].frequency, song[i].duration);
-    }
-}
-
-
-
-
-
-
@@ -7,22 +7,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <windows.h>
-#include <time.h>
-#include <math.h>
-
-/******************************************************
- * Estrutura node_t
- * 
- * Representa uma nota e suas propriedades
- *******************************************************/
-typedef struct 
-{
-    int midi;      //Representa o numero midi da nota.
-    int frequency; //Representa a frequência da nota.
-    int figure;    //Representa a figura rítmica da nota.
-    int duration;  //Representa a duração em milissegundos.
-}note_t;
+#include "../Comum/melodia.h"
 
 /************************************************************
  * Função: generate_song
@@ -33,62 +18,67 @@ typedef struct
  * - song: vetor onde a melodia será armazenada.
  * - notes_num: número de notas da melodia.
  * - seminima: número de semínimas por segundo na melodia.
+ * - seed: semente utilizada na geração de números aleatórios.
+ * - options: opções passadas por linha de comando.
  ************************************************************/
-void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, int octave);
-
-
-/************************************************************
- * Função: get_frequency
- * 
- * Retorna a frequência em Hz da nota passada por parâmetro.
- * 
- * Parâmetros:
- * - note: valor midi da nota cuja frequência é desejada.
- ************************************************************/
-double get_frequency(int note);
+void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, int octave, unsigned int seed, const options_t* options);
 
 
 /****************************************************************
- * Função: print_song
+ * Função: roll_dices
  * 
- * Imprime uma tabela contendo a sequência das notas utilizadas
- * na melodia, as respectivas frequências, figuras rítmicas e 
- * duração em milissegundos.
+ * Gera as notas com base na jogada dos dados. A tabela com o
+ * estado dos dados não é impressa no modo silencioso.
  * 
  * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
+ * - sum: vetor que armazena as somas dos dados(deve estar 
+ *        inicialmente preenchido com 0s).
+ * - size: número máximo de notas.
+ * - options: opções passadas por linha de comando.
  ***************************************************************/
-void print_song(note_t* song, unsigned int notes_num);
+void roll_dices(int* sum, int size, const options_t* options);
 
 
 /****************************************************************
- * Função: play_song
- * 
- * Toca a melodia composta utilizando a função beep.
- * 
+ * Função: append_dice_border
+ *
+ * Escreve no buffer a borda superior ou inferior da tabela de
+ * estado dos dados.
+ *
  * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
+ * - buffer: posição do buffer onde a borda será escrita.
+ * - dice_num: número de dados.
+ *
+ * Retorna o número de caracteres escritos.
  ***************************************************************/
-void play_song(note_t* song, unsigned int notes_num);
+size_t append_dice_border(char* buffer, int dice_num);
 
 
 /****************************************************************
- * Função: roll_dices
- * 
- * Gera as notas com base na jogada dos dados.
- * 
+ * Função: append_dice_row
+ *
+ * Escreve no buffer uma linha da tabela de estado dos dados no
+ * formato selecionado (tabela, csv ou jsonl). No csv, a linha usa
+ * as colunas de CSV_HEADER, com os campos das notas vazios.
+ *
  * Parâmetros:
- * - sum: vetor que armazena as somas dos dados(deve estar 
- *        inicialmente preenchido com 0s).
- * - size: número máximo de notas.
+ * - buffer: posição do buffer onde a linha será escrita.
+ * - note: índice da nota.
+ * - dice: vetor com os valores dos dados.
+ * - dice_num: número de dados.
+ * - dice_sum: soma dos valores dos dados.
+ * - options: opções passadas por linha de comando.
+ *
+ * Retorna o número de caracteres escritos.
  ***************************************************************/
-void roll_dices(int* sum, int size);
+size_t append_dice_row(char* buffer, int note, int* dice, int dice_num, int dice_sum, const options_t* options);
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    //Armazena as opções passadas por linha de comando.
+    options_t options;
+
     //Armazena a quantidade de seminimas por segundo.
     unsigned seminima = 0;
 
@@ -101,13 +91,17 @@ int main()
     //Vetor que armazenam as notas utilizadas na melodia.
     note_t* song = NULL;
 
-    printf("Seleciona a oitava:");
+    //Lê a semente e o intervalo do lote passados por linha de comando.
+    if(parse_options(argc, argv, &options) != 0)
+        return -1;
+
+    print_prompt(&options, "Seleciona a oitava:");
     scanf("%d", &octave);
 
-    printf("Numero de notas da melodia:");
+    print_prompt(&options, "Numero de notas da melodia:");
     scanf("%u", &notes_num);
 
-    printf("Seminimas por minuto:");
+    print_prompt(&options, "Seminimas por minuto:");
     scanf("%u", &seminima);
 
     //Aloca memória para as notas da melodia
@@ -120,16 +114,63 @@ int main()
         return -1;
     }
 
-    generate_song(song,notes_num,seminima,octave);
+    //Imprime o cabeçalho CSV antes de qualquer tabela.
+    print_csv_header(&options);
+
+    //No modo em lote, gera cada melodia do intervalo com uma semente derivada de seu índice.
+    if(options.batch)
+    {
+        for(unsigned int index = options.first; index < options.last; index++)
+        {
+            options.melody = index;
+
+            //O título vem antes da geração, que imprime as tabelas intermediárias da melodia.
+            if(options.format == FORMAT_TABLE)
+                printf("Melodia %u:\n", index);
+
+            generate_song(song,notes_num,seminima,octave,melody_seed(options.seed, index),&options);
+
+            output_song(song, notes_num, &options);
+        }
+
+        free(song);
+
+        return 0;
+    }
+
+    generate_song(song,notes_num,seminima,octave,options.seed,&options);
 
-    printf("Melodia Gerada:\n");
+    //A semente e o título são impressos apenas no formato de tabela, e a semente é omitida no modo silencioso.
+    if(options.format == FORMAT_TABLE)
+    {
+        if(!options.quiet)
+            printf("Semente utilizada: %u\n", options.seed);
+
+        printf("Melodia Gerada:\n");
+    }
 
     //Imprime a tabela de notas.
-    print_song(song, notes_num);
+    output_song(song, notes_num, &options);
 
     //Toca a melodia
     play_song(song, notes_num);
 
+    /*Permite alterar o andamento da melodia sem gerá-la novamente. Nos formatos csv e jsonl
+    a melodia é impressa uma única vez, para que cada par (melodia, nota) identifique uma só linha.*/
+    while(options.format == FORMAT_TABLE)
+    {
+        print_prompt(&options, "Novas seminimas por minuto (0 para sair):");
+
+        if(scanf("%u", &seminima) != 1 || seminima == 0)
+            break;
+
+        set_tempo(song, notes_num, seminima);
+
+        output_song(song, notes_num, &options);
+
+        play_song(song, notes_num);
+    }
+
     if(song != NULL)
         free(song);
 
@@ -138,62 +179,45 @@ int main()
 
 
 //Definição da função generate_song
-void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, int octave)
+void generate_song(note_t* song, unsigned int notes_num, unsigned int seminima, int octave, unsigned int seed, const options_t* options)
 {
-    //Vetor que armazena a duração das figuras rítmicas.
-    int duration[7] = {0};
-
     //Variável auxiliar que representa a última nota utilizada na melodia.
     int last_note_index = 0;
 
     //Variável auxiliar.
     int temp = 0;
 
+    //Espaço restante no compasso atual, em semifusas.
+    int bar_space = BAR_SIZE;
+
     //Vetor que armazena as somas dos valores dos dados.
     int* sum = NULL;
 
     sum = calloc(notes_num,sizeof(int));
 
     //Semente para geração de números aleatórios
-    srand((unsigned)time(NULL));
-
-    //Computa a duração de uma semínima.
-    duration[4] = (60000.0)/seminima;
-
-    //Calcula as durações das demais figuras rítmicas.
-    for(int i = 0; i< 7; i++)
-    {
-        if(i != 4)
-          duration[i] = duration[4]*pow(2,i-4);
-    }
+    srand(seed);
 
     //Gera a sequência de notas através do algoritmo de composição baseado em dados.
-    roll_dices(sum,notes_num);
+    roll_dices(sum,notes_num,options);
     
     //Completa o vetor de notas da melodia com os valores adequados.
     for(int i = 0; i<notes_num; i++)
     {
         song[i].midi = (sum[i]+(12*(octave+1)))%127;
         song[i].frequency = get_frequency(song[i].midi);
-        song[i].figure = rand()%7;
-        song[i].duration = duration[song[i].figure];
+        song[i].figure = choose_figure(&bar_space);
     }
 
+    //Atribui a duração das notas de acordo com o andamento.
+    set_tempo(song, notes_num, seminima);
+
     if(sum != NULL)
         free(sum);
 }
 
-//Definicação da função get_frequency.
-double get_frequency(int note)
-{
-    //Calcula a frequência com base na frequência do Lá Central (69).
-    double power = (note - 69)/12.0;
-    return 440*pow(2,power);
-}
-
-
 //Definição da função roll_dices.
-void roll_dices(int* sum, int size)
+void roll_dices(int* sum, int size, const options_t* options)
 {
     //Armazena o número da nota em binário.
     int current_bits = 0;
@@ -207,6 +231,15 @@ void roll_dices(int* sum, int size)
     //Vetor que armazena os valores dos dados.
     int* dice = NULL;
 
+    //Armazena a soma atual dos valores dos dados.
+    int dice_sum = 0;
+
+    //Buffer que acumula as linhas da tabela antes da impressão.
+    static char buffer[OUTPUT_BUFFER_SIZE];
+
+    //Posição atual no buffer.
+    size_t pos = 0;
+
     //Verifica quantos dados são necessários para compor a melodia.
     while(aux<size)
     {
@@ -217,13 +250,11 @@ void roll_dices(int* sum, int size)
     dice = (int*)calloc(dice_num,sizeof(int));
 
     //Imprime o cabeçalho da tabela contendo os resultados do algoritmo 
-    printf("+");
-    
-    for(int k = 0; k<3*dice_num+4; k++)
-        printf("-");
-
-    printf("+");
-    printf("\n");
+    if(!options->quiet)
+    {
+        if(options->format == FORMAT_TABLE)
+            pos += append_dice_border(buffer+pos, dice_num);
+    }
 
     //Laço para a execução do algoritmo de lançamento de dados.
     for(int i = 0; i<size; i++)
@@ -231,7 +262,10 @@ void roll_dices(int* sum, int size)
         if(i == 0)
         {
             for(int i = 0; i<dice_num; i++)
-            dice[i] = (rand()%6)+1;
+            {
+                dice[i] = (rand()%6)+1;
+                dice_sum += dice[i];
+            }
 
         }else{
             
@@ -243,43 +277,41 @@ void roll_dices(int* sum, int size)
             for(int j = 1; aux>0 && j<=dice_num; j++)
             {
                 if(aux & 1)
+                {
+                    //Atualiza a soma apenas com a diferença do dado relançado.
+                    dice_sum -= dice[dice_num-j];
                     dice[dice_num-j] = (rand()%6)+1;
+                    dice_sum += dice[dice_num-j];
+                }
                 
                 aux>>=1;
             } 
         }
 
-        //Soma o valor dos dados.
-        for(int j = 0; j< dice_num; j++)
-            sum[i]+= dice[j];
+        //Armazena a soma dos valores dos dados.
+        sum[i] = dice_sum;
 
         //Imprime os dados tabela contendo os resultados do algoritmo 
-        printf("|");
-
-        for(int k = 0; k<dice_num; k++)
-            printf("%d", (((1<<dice_num-1)&(i<<k))>0)?1:0);
-
-        printf("|");
-
-        for(int j = 0; j<dice_num; j++)
-            printf("%d ", dice[j]);
-
-        printf("|");
+        if(!options->quiet)
+        {
+            //Esvazia o buffer quando não houver espaço para mais uma linha.
+            if(pos > OUTPUT_BUFFER_SIZE - OUTPUT_LINE_MAX)
+                pos = flush_buffer(buffer, pos);
 
-        printf("%2d", sum[i]);
-         printf("|\n");
+            pos += append_dice_row(buffer+pos, i, dice, dice_num, sum[i], options);
+        }
 
          current_bits++;
     }
-    //Impressão do fim da tabela do algoritmo.
-    printf("+");
-    
-    for(int k = 0; k<3*dice_num+4; k++)
-        printf("-");
 
-    printf("+");
+    //Impressão do fim da tabela do algoritmo.
+    if(!options->quiet)
+    {
+        if(options->format == FORMAT_TABLE)
+            pos += append_dice_border(buffer+pos, dice_num);
 
-    printf("\n");
+        flush_buffer(buffer, pos);
+    }
 
     if(dice != NULL)
         free(dice);
@@ -287,32 +319,108 @@ void roll_dices(int* sum, int size)
 }
 
 
-//Definicação da função print_song.
-void print_song(note_t* song, unsigned int notes_num)
+//Definição da função append_dice_border.
+size_t append_dice_border(char* buffer, int dice_num)
 {
-    printf("+----+----------+------+-----------+\n");
-    printf("|MIDI|FREQUENCIA|FIGURA|DURACAO(ms)|\n");
-    printf("+----+----------+------+-----------+\n");
-    for(int i = 0; i<notes_num; i++)
-    {
-        printf("| %d |   %4d   |   %d  |   %5d   |\n", song[i].midi, song[i].frequency, 
-        song[i].figure, song[i].duration);
-    }
-    printf("+----------------------------------+\n");
+    size_t pos = 0;
+
+    buffer[pos++] = '+';
+
+    for(int k = 0; k<3*dice_num+4; k++)
+        buffer[pos++] = '-';
+
+    pos += append_text(buffer+pos, "+\n");
+
+    return pos;
 }
 
-//Definicação da função play_song.
-void play_song(note_t* song, unsigned int notes_num)
+
+//Definição da função append_dice_row.
+size_t append_dice_row(char* buffer, int note, int* dice, int dice_num, int dice_sum, const options_t* options)
 {
-    //Toca a frequência de cada nota por um tempo igual a sua duração.
-    for(int i = 0; i < notes_num; i++)
+    size_t pos = 0;
+
+    switch(options->format)
     {
-        Beep(song[i].frequency, song[i].duration);
+        case FORMAT_CSV:
+            pos += append_text(buffer+pos, "dados,");
+            pos += append_uint(buffer+pos, options->melody, 0);
+            buffer[pos++] = ',';
+            pos += append_int(buffer+pos, note, 0);
+
+            //Campos midi, frequencia, figura e duracao vazios.
+            pos += append_text(buffer+pos, ",,,,,");
+        break;
+
+        case FORMAT_JSONL:
+            pos += append_text(buffer+pos, "{\"tabela\":\"dados\",\"melodia\":");
+            pos += append_uint(buffer+pos, options->melody, 0);
+            pos += append_text(buffer+pos, ",\"nota\":");
+            pos += append_int(buffer+pos, note, 0);
+            pos += append_text(buffer+pos, ",\"bits\":\"");
+        break;
+
+        default:
+            buffer[pos++] = '|';
+        break;
     }
-}
 
+    //Escreve o número da nota em binário.
+    for(int k = 0; k<dice_num; k++)
+        buffer[pos++] = (((1<<(dice_num-1))&(note<<k))>0)?'1':'0';
 
+    switch(options->format)
+    {
+        case FORMAT_CSV:
+            buffer[pos++] = ',';
 
+            //Os valores dos dados ficam em um único campo, separados por espaços.
+            for(int j = 0; j<dice_num; j++)
+            {
+                if(j > 0)
+                    buffer[pos++] = ' ';
 
+                buffer[pos++] = '0' + dice[j];
+            }
 
+            buffer[pos++] = ',';
+            pos += append_int(buffer+pos, dice_sum, 0);
 
+            //Campos linha e valores vazios.
+            pos += append_text(buffer+pos, ",,\n");
+        break;
+
+        case FORMAT_JSONL:
+            pos += append_text(buffer+pos, "\",\"dados\":[");
+
+            for(int j = 0; j<dice_num; j++)
+            {
+                if(j > 0)
+                    buffer[pos++] = ',';
+
+                buffer[pos++] = '0' + dice[j];
+            }
+
+            pos += append_text(buffer+pos, "],\"soma\":");
+            pos += append_int(buffer+pos, dice_sum, 0);
+            pos += append_text(buffer+pos, "}\n");
+        break;
+
+        default:
+            buffer[pos++] = '|';
+
+            for(int j = 0; j<dice_num; j++)
+            {
+                buffer[pos++] = '0' + dice[j];
+                buffer[pos++] = ' ';
+            }
+
+            buffer[pos++] = '|';
+
+            pos += append_int(buffer+pos, dice_sum, 2);
+            pos += append_text(buffer+pos, "|\n");
+        break;
+    }
+
+    return pos;
+}
@@ -7,22 +7,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <windows.h>
-#include <time.h>
-#include <math.h>
-
-/******************************************************
- * Estrutura node_t
- * 
- * Representa uma nota e suas propriedades
- *******************************************************/
-typedef struct 
-{
-    int midi;      //Representa o numero midi da nota.
-    int frequency; //Representa a frequência da nota.
-    int figure;    //Representa a figura rítmica da nota.
-    int duration;  //Representa a duração em milissegundos.
-}note_t;
+#include "../Comum/melodia.h"
 
 /************************************************************
  * Função: generate_song
@@ -34,19 +19,10 @@ typedef struct
  * - series_num: número de notas da melodia.
  * - seminima: número de semínimas por segundo na melodia.
  * - octave: oitava na qual as séries serão geradas.    
+ * - seed: semente utilizada na geração de números aleatórios.
+ * - options: opções passadas por linha de comando.
  ************************************************************/
-void generate_song(note_t* song, unsigned int series_num, unsigned int seminima, int octave);
-
-
-/************************************************************
- * Função: get_frequency
- * 
- * Retorna a frequência em Hz da nota passada por parâmetro.
- * 
- * Parâmetros:
- * - note: valor midi da nota cuja frequência é desejada.
- ************************************************************/
-double get_frequency(int note);
+void generate_song(note_t* song, unsigned int series_num, unsigned int seminima, int octave, unsigned int seed, const options_t* options);
 
 
 /******************************************************************
@@ -74,34 +50,25 @@ void shuffle(int* array, unsigned int size);
 void inverse(int* matrix_array, int* array, unsigned int size);
 
 
-/****************************************************************
- * Função: print_song
- * 
- * Imprime uma tabela contendo a sequência das notas utilizadas
- * na melodia, as respectivas frequências, figuras rítmicas e 
- * duração em milissegundos.
- * 
- * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
- ***************************************************************/
-void print_song(note_t* song, unsigned int notes_num);
-
-
-/****************************************************************
- * Função: play_song
+/****************************************************************** 
+ * Função: print_matrix
  * 
- * Toca a melodia composta utilizando a função beep.
+ * Imprime a matriz dodecafônica no formato selecionado (tabela,
+ * csv ou jsonl). No csv, cada linha usa as colunas de CSV_HEADER,
+ * preenchendo apenas tabela, melodia, linha e valores.
  * 
  * Parâmetros:
- * - song: vetor de notas que compõem a melodia.
- * - notes_num: número de notas da melodia.
- ***************************************************************/
-void play_song(note_t* song, unsigned int notes_num);
+ * - matrix: matriz dodecafônica 12x12.
+ * - options: opções passadas por linha de comando.
+ ******************************************************************/
+void print_matrix(int matrix[12][12], const options_t* options);
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    //Armazena as opções passadas por linha de comando.
+    options_t options;
+
     //Armazena a quantidade de seminimas por segundo.
     unsigned seminima = 0;
 
@@ -114,13 +81,17 @@ int main()
     //Vetor que armazenam as notas utilizadas na melodia.
     note_t* song = NULL;
 
-    printf("Seleciona a oitava:");
+    //Lê a semente e o intervalo do lote passados por linha de comando.
+    if(parse_options(argc, argv, &options) != 0)
+        return -1;
+
+    print_prompt(&options, "Seleciona a oitava:");
     scanf("%d", &octave);
 
-    printf("Numero de series da melodia:");
+    print_prompt(&options, "Numero de series da melodia:");
     scanf("%u", &series_num);
 
-    printf("Seminimas por minuto:");
+    print_prompt(&options, "Seminimas por minuto:");
     scanf("%u", &seminima);
 
     //Aloca memória para as notas da melodia
@@ -133,16 +104,63 @@ int main()
         return -1;
     }
 
-    generate_song(song,series_num,seminima,octave);
+    //Imprime o cabeçalho CSV antes de qualquer tabela.
+    print_csv_header(&options);
+
+    //No modo em lote, gera cada melodia do intervalo com uma semente derivada de seu índice.
+    if(options.batch)
+    {
+        for(unsigned int index = options.first; index < options.last; index++)
+        {
+            options.melody = index;
+
+            //O título vem antes da geração, que imprime as tabelas intermediárias da melodia.
+            if(options.format == FORMAT_TABLE)
+                printf("Melodia %u:\n", index);
+
+            generate_song(song,series_num,seminima,octave,melody_seed(options.seed, index),&options);
+
+            output_song(song, series_num*12, &options);
+        }
+
+        free(song);
+
+        return 0;
+    }
+
+    generate_song(song,series_num,seminima,octave,options.seed,&options);
 
-    printf("\nMelodia Gerada:\n");
+    //A semente e o título são impressos apenas no formato de tabela, e a semente é omitida no modo silencioso.
+    if(options.format == FORMAT_TABLE)
+    {
+        if(!options.quiet)
+            printf("Semente utilizada: %u\n", options.seed);
+
+        printf("\nMelodia Gerada:\n");
+    }
 
     //Imprime a tabela de notas.
-    print_song(song, series_num*12);
+    output_song(song, series_num*12, &options);
 
     //Toca a melodia
     play_song(song, series_num*12);
 
+    /*Permite alterar o andamento da melodia sem gerá-la novamente. Nos formatos csv e jsonl
+    a melodia é impressa uma única vez, para que cada par (melodia, nota) identifique uma só linha.*/
+    while(options.format == FORMAT_TABLE)
+    {
+        print_prompt(&options, "Novas seminimas por minuto (0 para sair):");
+
+        if(scanf("%u", &seminima) != 1 || seminima == 0)
+            break;
+
+        set_tempo(song, series_num*12, seminima);
+
+        output_song(song, series_num*12, &options);
+
+        play_song(song, series_num*12);
+    }
+
     if(song != NULL)
         free(song);
 
@@ -151,13 +169,10 @@ int main()
 
 
 //Definição da função generate_song
-void generate_song(note_t* song, unsigned int series_num, unsigned int seminima, int octave)
+void generate_song(note_t* song, unsigned int series_num, unsigned int seminima, int octave, unsigned int seed, const options_t* options)
 {
     int series[12] = {0,1,2,3,4,5,6,7,8,9,10,11};
 
-    //Vetor que armazena a duração das figuras rítmicas.
-    int duration[7] = {0};
-
     //Matriz 12x12 dodecafônica.
     int matrix [12][12] = {0};
 
@@ -167,18 +182,11 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
     //Variável auxiliar.
     int value = 0;
 
-    //Semente para geração de números aleatórios.
-    srand((unsigned)time(NULL));
+    //Espaço restante no compasso atual, em semifusas.
+    int bar_space = BAR_SIZE;
 
-    //Computa a duração de uma semínima.
-    duration[4] = (60000.0)/seminima;
-
-    //Calcula as durações das demais figuras rítmicas.
-    for(int i = 0; i< 7; i++)
-    {
-        if(i != 4)
-          duration[i] = duration[4]*pow(2,i-4);
-    }
+    //Semente para geração de números aleatórios.
+    srand(seed);
 
     //Embaralha o vetor series para gerar uma série dodecafônica aleatória. 
     shuffle(series,12);
@@ -207,16 +215,9 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
         }
     }
     
-    printf("Matriz dodecafonica:\n");
-    
-    //Imprime a matriz dodecafônica
-    for(int i = 0; i<12; i++)
-    {
-        for(int j = 0; j<12; j++)
-            printf("%2d ", matrix[i][j]);
-
-        printf("\n");
-    }
+    //Imprime a matriz dodecafônica, exceto no modo silencioso.
+    if(!options->quiet)
+        print_matrix(matrix, options);
 
     //Seleciona séries aleatórias da matriz dodecafônica gerada
     for(int i = 0; i<series_num; i++)
@@ -231,8 +232,7 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
                 {
                     song[(12*i)+j].midi = matrix[aux_index][j]+(12*(octave+1));
                     song[(12*i)+j].frequency = get_frequency(song[(12*i)+j].midi);
-                    song[(12*i)+j].figure = rand()%7;
-                    song[(12*i)+j].duration = duration[song[(12*i)+j].figure];
+                    song[(12*i)+j].figure = choose_figure(&bar_space);
                 }
             break;
 
@@ -241,8 +241,7 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
                 {
                     song[(12*i)+(11-j)].midi = matrix[aux_index][j]+(12*(octave+1));
                     song[(12*i)+(11-j)].frequency = get_frequency(song[(12*i)+(11-j)].midi);
-                    song[(12*i)+(11-j)].figure = rand()%7;
-                    song[(12*i)+(11-j)].duration = duration[song[(12*i)+(11-j)].figure];
+                    song[(12*i)+(11-j)].figure = choose_figure(&bar_space);
                 }
             break;
 
@@ -251,8 +250,7 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
                 {
                     song[(12*i)+j].midi = matrix[j][aux_index]+(12*(octave+1));
                     song[(12*i)+j].frequency = get_frequency(song[(12*i)+j].midi);
-                    song[(12*i)+j].figure = rand()%7;
-                    song[(12*i)+j].duration = duration[song[(12*i)+j].figure];
+                    song[(12*i)+j].figure = choose_figure(&bar_space);
                 }
             break;
 
@@ -261,24 +259,17 @@ void generate_song(note_t* song, unsigned int series_num, unsigned int seminima,
                 {
                     song[(12*i)+(11-j)].midi = matrix[j][aux_index]+(12*(octave+1));
                     song[(12*i)+(11-j)].frequency = get_frequency(song[(12*i)+(11-j)].midi);
-                    song[(12*i)+(11-j)].figure = rand()%7;
-                    song[(12*i)+(11-j)].duration = duration[song[(12*i)+(11-j)].figure];
+                    song[(12*i)+(11-j)].figure = choose_figure(&bar_space);
                     
                 }
             break;
         }
     }
-}
 
-//Definicação da função get_frequency.
-double get_frequency(int note)
-{
-    //Calcula a frequência com base na frequência do Lá Central (69).
-    double power = (note - 69)/12.0;
-    return 440*pow(2,power);
+    //Atribui a duração das notas de acordo com o andamento.
+    set_tempo(song, series_num*12, seminima);
 }
 
-
 //Definição da função shuffle
 void shuffle(int* array, unsigned int size)
 {
@@ -317,32 +308,29 @@ void inverse(int* inverse_array, int* array, unsigned int size)
 }
 
 
-//Definicação da função print_song.
-void print_song(note_t* song, unsigned int notes_num)
+//Definição da função print_matrix.
+void print_matrix(int matrix[12][12], const options_t* options)
 {
-    printf("+----+----------+------+-----------+\n");
-    printf("|MIDI|FREQUENCIA|FIGURA|DURACAO(ms)|\n");
-    printf("+----+----------+------+-----------+\n");
-    for(int i = 0; i<notes_num; i++)
-    {
-        printf("| %2d |   %4d   |   %d  |   %5d   |\n", song[i].midi, song[i].frequency, 
-        song[i].figure, song[i].duration);
-    }
-    printf("+----------------------------------+\n");
-}
+    if(options->format == FORMAT_TABLE)
+        printf("Matriz dodecafonica:\n");
 
-//Definicação da função play_song.
-void play_song(note_t* song, unsigned int notes_num)
-{
-    //Toca a frequência de cada nota por um tempo igual a sua duração.
-    for(int i = 0; i < notes_num; i++)
+    for(int i = 0; i<12; i++)
     {
-        Beep(song[i].frequency, song[i].duration);
-    }
-}
-
-
-
-
+        if(options->format == FORMAT_CSV)
+            printf("matriz,%u,,,,,,,,,%d,", options->melody, i);
+        else if(options->format == FORMAT_JSONL)
+            printf("{\"tabela\":\"matriz\",\"melodia\":%u,\"linha\":%d,\"valores\":[", options->melody, i);
 
+        for(int j = 0; j<12; j++)
+        {
+            if(options->format == FORMAT_TABLE)
+                printf("%2d ", matrix[i][j]);
+            else if(options->format == FORMAT_CSV)
+                printf((j > 0) ? " %d" : "%d", matrix[i][j]);
+            else
+                printf((j > 0) ? ",%d" : "%d", matrix[i][j]);
+        }
 
+        printf((options->format == FORMAT_JSONL) ? "]}\n" : "\n");
+    }
+}